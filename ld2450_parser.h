@@ -0,0 +1,137 @@
+#pragma once
+
+// LD2450 frame handling with no ESPHome dependencies, so recorded or
+// synthetic frames can be replayed on a host (see test/).
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "zone_core.h"
+
+// Report frame layout: 4 byte header, 3 x 8 byte target blocks, 2 byte tail
+namespace LD2450Frame {
+    constexpr size_t HEADER_SIZE = 4;
+    constexpr size_t TARGET_SIZE = 8;
+    constexpr size_t TAIL_SIZE = 2;
+    constexpr int MAX_TARGETS = 3;
+    constexpr size_t FRAME_SIZE = HEADER_SIZE + MAX_TARGETS * TARGET_SIZE + TAIL_SIZE;  // 30
+    constexpr uint8_t HEADER[HEADER_SIZE] = {0xAA, 0xFF, 0x03, 0x00};
+    constexpr uint8_t TAIL[TAIL_SIZE] = {0x55, 0xCC};
+}
+
+/**
+ * Pull the next complete report frame out of a receive buffer.
+ * Bytes before a frame header (e.g. echoed commands) are dropped, and a
+ * header whose tail does not match is skipped so the stream can resync.
+ *
+ * @param buffer Accumulated UART bytes; consumed bytes are erased
+ * @param frame Receives the frame when one is available
+ * @param bad_frames Incremented for every header without a valid tail
+ * @return true if a frame was extracted
+ */
+bool extract_ld2450_frame(std::vector<uint8_t>& buffer, std::vector<uint8_t>& frame,
+                          unsigned long& bad_frames) {
+    using namespace LD2450Frame;
+    while (true) {
+        auto it = std::search(buffer.begin(), buffer.end(), HEADER, HEADER + HEADER_SIZE);
+        if (it == buffer.end()) {
+            // Keep a possible partial header at the end of the buffer
+            size_t keep = std::min(buffer.size(), HEADER_SIZE - 1);
+            buffer.erase(buffer.begin(), buffer.end() - keep);
+            return false;
+        }
+        buffer.erase(buffer.begin(), it);
+
+        if (buffer.size() < FRAME_SIZE) {
+            // Wait for the rest of the frame
+            return false;
+        }
+
+        if (buffer[FRAME_SIZE - 2] == TAIL[0] && buffer[FRAME_SIZE - 1] == TAIL[1]) {
+            frame.assign(buffer.begin(), buffer.begin() + FRAME_SIZE);
+            buffer.erase(buffer.begin(), buffer.begin() + FRAME_SIZE);
+            return true;
+        }
+
+        // Header without a matching tail: skip it and look for the next one
+        bad_frames++;
+        buffer.erase(buffer.begin());
+    }
+}
+
+/**
+ * Decode the target blocks of an LD2450 report frame into positions.
+ *
+ * @param bytes Raw report frame (header at offset 0, targets from offset 4)
+ * @param p Output positions, at least num_targets entries
+ * @param num_targets Number of 8-byte target blocks to decode
+ * @return false if the frame is too short; p is left untouched
+ */
+bool parse_ld2450_targets(const std::vector<uint8_t>& bytes, Position p[], int num_targets) {
+    if (num_targets < 0 ||
+        bytes.size() < LD2450Frame::HEADER_SIZE + LD2450Frame::TARGET_SIZE * num_targets) {
+        return false;
+    }
+
+    int b = 0;
+    for (int i = 0; i < num_targets; i++) {
+        // Parse X coordinate
+        p[i].x = (uint16_t((bytes[b+5] << 8) | bytes[b+4]));
+        if ((bytes[b+5] & 0x80) >> 7) {
+            p[i].x -= 32768;
+        } else {
+            p[i].x = 0 - p[i].x;
+        }
+        p[i].x = p[i].x * -1;
+
+        // Parse Y coordinate
+        p[i].y = (uint16_t((bytes[b+7] << 8) | bytes[b+6]));
+        if ((bytes[b+7] & 0x80) >> 7) {
+            p[i].y -= 32768;
+        } else {
+            p[i].y = 0 - p[i].y;
+        }
+
+        // Parse speed
+        p[i].speed = (bytes[b+9] << 8 | bytes[b+8]);
+        if ((bytes[b+9] & 0x80) >> 7) {
+            p[i].speed -= 32768;
+        } else {
+            p[i].speed = 0 - p[i].speed;
+        }
+
+        // Parse distance resolution - THIS IS UNSIGNED, NO SIGN CONVERSION
+        p[i].distance_resolution = (uint16_t((bytes[b+11] << 8) | bytes[b+10]));
+
+        // Target is valid if it has non-zero coordinates or positive Y
+        p[i].valid = (p[i].x != 0 || p[i].y > 0);
+
+        // Reset exclusion flag
+        p[i].zone_ex_enter = false;
+
+        b += 8; // Move to next target data block
+    }
+    return true;
+}
+
+/**
+ * Count valid targets inside and outside a zone.
+ * Targets already claimed by an exclusion zone are skipped; when
+ * mark_excluded is set, targets found inside are claimed by this zone.
+ */
+void count_targets_in_zone(Zone& z, Position p[], int num_targets, float angle, bool mark_excluded) {
+    for (int j = 0; j < num_targets; j++) {
+        if (!p[j].valid || (!mark_excluded && p[j].zone_ex_enter)) {
+            continue;
+        }
+        if (check_targets_in_zone(z, p[j], angle)) {
+            z.target_count++;
+            if (mark_excluded) {
+                p[j].zone_ex_enter = true;
+            }
+        } else {
+            z.outside_target_count++;
+        }
+    }
+}
@@ -1,8 +1,10 @@
 #pragma once
 #include "zone.h"
+#include "ld2450_parser.h"
 
 void process_ld2450_data(
     const std::vector<uint8_t>& bytes,
+    std::vector<uint8_t>& packet_buffer,
     unsigned long& last_update,
     unsigned long& update_counter,
     unsigned long& last_rate_calc,
@@ -44,26 +46,28 @@ void process_ld2450_data(
     const int NUM_ZONES = 3;
     const int NUM_ZONES_EX = 1;
     const int NUM_TARGETS = 3;
-    const int MIN_PACKET_SIZE = 30;
-    const int EXPECTED_PACKET_SIZE = 48;
-    static std::vector<uint8_t> packet_buffer;
+    std::vector<uint8_t> packet;
+    bool have_packet = false;
+    unsigned long bad_frames = 0;
 
-    // Append new bytes to buffer
+    // Append new bytes to buffer and keep the newest complete frame
     packet_buffer.insert(packet_buffer.end(), bytes.begin(), bytes.end());
+    while (extract_ld2450_frame(packet_buffer, packet, bad_frames)) {
+        have_packet = true;
+    }
+
+    if (bad_frames > 0) {
+        packet_error_count = packet_error_count + bad_frames;
+        packet_errors->publish_state(packet_error_count);
+        radar_status->publish_state("Packet Error");
+        ESP_LOGW("ld2450", "Discarded %lu malformed frame(s)", bad_frames);
+    }
 
-    // Only process if we have at least a full packet
-    const int FULL_PACKET_SIZE = 48;
-    if (packet_buffer.size() < FULL_PACKET_SIZE) {
+    if (!have_packet) {
         // Not enough data yet; exit and wait for next update
         return;
     }
 
-    // Take first full packet for processing
-    std::vector<uint8_t> packet(packet_buffer.begin(), packet_buffer.begin() + FULL_PACKET_SIZE);
-
-    // Remove the processed bytes from the buffer
-    packet_buffer.erase(packet_buffer.begin(), packet_buffer.begin() + FULL_PACKET_SIZE);
-
     unsigned long current_time = millis();
     if ((current_time - last_update) <= update_interval_ms->state) { 
         return;
@@ -78,59 +82,16 @@ void process_ld2450_data(
         last_rate_calc = current_time;
     }
 
-    if (bytes.size() < MIN_PACKET_SIZE) {
-        packet_error_count = packet_error_count + 1;
-        packet_errors->publish_state(packet_error_count);
-        radar_status->publish_state("Packet Error");
-        ESP_LOGW("ld2450", "Invalid packet size: %d", bytes.size());
-        return;
-    }
-    
     float angle = wall_angle->state;
-    float pos_threshold = position_threshold->state;
     float speed_thresh = speed_threshold->state;
+    (void) position_threshold;  // Exposed in the UI but not applied to targets yet
     
     struct Position p[NUM_TARGETS];
     struct Zone zone_ex[NUM_ZONES_EX], zone[NUM_ZONES];
     
     // Parse target data
-    int b = 0;
-    for (int i = 0; i < NUM_TARGETS; i++) {
-        // Parse X coordinate
-        p[i].x = (uint16_t((bytes[b+5] << 8) | bytes[b+4]));
-        if ((bytes[b+5] & 0x80) >> 7) {
-            p[i].x -= 32768;
-        } else {
-            p[i].x = 0 - p[i].x;
-        }
-        p[i].x = p[i].x * -1;
-    
-        // Parse Y coordinate
-        p[i].y = (uint16_t((bytes[b+7] << 8) | bytes[b+6]));
-        if ((bytes[b+7] & 0x80) >> 7) {
-            p[i].y -= 32768;
-        } else {
-            p[i].y = 0 - p[i].y;
-        }
-    
-        // Parse speed
-        p[i].speed = (bytes[b+9] << 8 | bytes[b+8]);
-        if ((bytes[b+9] & 0x80) >> 7) {
-            p[i].speed -= 32768;
-        } else {
-            p[i].speed = 0 - p[i].speed;
-        }
-        
-        // Parse distance resolution - THIS IS UNSIGNED, NO SIGN CONVERSION
-        p[i].distance_resolution = (uint16_t((bytes[b+11] << 8) | bytes[b+10]));
-        
-        // Target is valid if it has non-zero coordinates or positive Y
-        p[i].valid = (p[i].x != 0 || p[i].y > 0);
-        
-        // Reset exclusion flag
-        p[i].zone_ex_enter = false;
-        
-        b += 8; // Move to next target data block
+    if (!parse_ld2450_targets(packet, p, NUM_TARGETS)) {
+        return;
     }
     
     // Process exclusion zones
@@ -142,16 +103,7 @@ void process_ld2450_data(
         zone_ex[i].resetCounts();
 
         if (zone_ex_enable[i]->state && zone_ex[i].isConfigured()) {
-            for (int j = 0; j < NUM_TARGETS; j++) {
-                if (p[j].valid) {
-                    if (check_targets_in_zone(zone_ex[i], p[j], angle)) {
-                        zone_ex[i].target_count++;
-                        p[j].zone_ex_enter = true;
-                    } else { 
-                        zone_ex[i].outside_target_count++;
-                    }
-                }
-            }
+            count_targets_in_zone(zone_ex[i], p, NUM_TARGETS, angle, true);
         }
         zone_ex[i].has_target = (zone_ex[i].target_count > 0);
         zone_ex[i].has_target_outside = (zone_ex[i].outside_target_count > 0);
@@ -176,15 +128,7 @@ void process_ld2450_data(
             zone[i].resetCounts();
             
             if (zone[i].isConfigured()) {
-                for (int j = 0; j < NUM_TARGETS; j++) {
-                    if (p[j].valid && !p[j].zone_ex_enter) {
-                        if (check_targets_in_zone(zone[i], p[j], angle)) {
-                            zone[i].target_count++;
-                        } else { 
-                            zone[i].outside_target_count++;
-                        }
-                    }
-                }
+                count_targets_in_zone(zone[i], p, NUM_TARGETS, angle, false);
             }
             zone[i].has_target = (zone[i].target_count > 0);
             zone[i].has_target_outside = (zone[i].outside_target_count > 0);
@@ -0,0 +1,49 @@
+#pragma once
+
+// Minimal stand-ins for the ESPHome symbols used by zone.h and
+// ld2450_processor.h, so the device code can be driven on a host.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Logging is compiled out but still type-checks (and uses) its arguments
+#define ESP_LOG_STUB(tag, ...) ((void) sizeof(tag), (void) sizeof(std::printf(__VA_ARGS__)))
+#define ESP_LOGD(tag, ...) ESP_LOG_STUB(tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) ESP_LOG_STUB(tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) ESP_LOG_STUB(tag, __VA_ARGS__)
+
+namespace template_ {
+
+template<typename T> struct StubEntity {
+    T state{};
+    int publish_count = 0;
+
+    template<typename V> void publish_state(V value) {
+        state = static_cast<T>(value);
+        publish_count++;
+    }
+};
+
+using TemplateNumber = StubEntity<float>;
+using TemplateSensor = StubEntity<float>;
+using TemplateSwitch = StubEntity<bool>;
+using TemplateBinarySensor = StubEntity<bool>;
+
+struct TemplateTextSensor {
+    std::string state;
+    int publish_count = 0;
+
+    void publish_state(const std::string& value) {
+        state = value;
+        publish_count++;
+    }
+};
+
+}  // namespace template_
+
+// Advanced by the simulator; the processor throttles on it
+inline unsigned long stub_millis = 0;
+inline unsigned long millis() { return stub_millis; }
+
+template<typename T> T& id(T* value) { return *value; }
@@ -0,0 +1,883 @@
+// Host-side LD2450 simulator and zone accuracy/performance regression suite.
+//
+// Scripted scenarios (walking, sitting, zone edge crossings at several
+// wall_angle values, multipath ghosts, fragmented UART delivery) are encoded
+// into LD2450 report frames and fed through the real process_ld2450_data().
+// Zone occupancy is compared against exact ground truth to get precision,
+// recall and boundary flip-flops. Every scenario has a fixed seed and its
+// confusion counts must match the recorded baseline exactly. Timing per
+// frame is reported but not gated.
+
+// Included first and on its own: the ESPHome-free headers must stand alone
+#include "ld2450_parser.h"
+
+#include "esphome_stubs.h"
+#include "ld2450_processor.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+int failures = 0;
+
+#define CHECK(cond)                                                       \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);   \
+            failures++;                                                   \
+        }                                                                 \
+    } while (0)
+
+// ---------------------------------------------------------------------------
+// Frame encoder (inverse of parse_ld2450_targets)
+// ---------------------------------------------------------------------------
+
+struct SimTarget {
+    int16_t x = 0;
+    int16_t y = 0;
+    int16_t speed = 0;
+    uint16_t resolution = 0;
+};
+
+// LD2450 fields are sign-magnitude with bit 15 set for non-negative values
+uint16_t encode_sign_magnitude(int16_t value) {
+    if (value >= 0) {
+        return static_cast<uint16_t>(0x8000 | value);
+    }
+    return static_cast<uint16_t>(-value);
+}
+
+void put_u16(std::vector<uint8_t>& frame, size_t offset, uint16_t value) {
+    frame[offset] = static_cast<uint8_t>(value & 0xFF);
+    frame[offset + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+std::vector<uint8_t> encode_ld2450_frame(const std::vector<SimTarget>& targets) {
+    using namespace LD2450Frame;
+    std::vector<uint8_t> frame(FRAME_SIZE, 0);
+    std::copy(HEADER, HEADER + HEADER_SIZE, frame.begin());
+    for (size_t i = 0; i < targets.size() && i < static_cast<size_t>(MAX_TARGETS); i++) {
+        size_t b = HEADER_SIZE + i * TARGET_SIZE;
+        // The parser mirrors X, so the sensor reports it negated
+        put_u16(frame, b, encode_sign_magnitude(static_cast<int16_t>(-targets[i].x)));
+        put_u16(frame, b + 2, encode_sign_magnitude(targets[i].y));
+        put_u16(frame, b + 4, encode_sign_magnitude(targets[i].speed));
+        put_u16(frame, b + 6, targets[i].resolution);
+    }
+    std::copy(TAIL, TAIL + TAIL_SIZE, frame.end() - TAIL_SIZE);
+    return frame;
+}
+
+// ---------------------------------------------------------------------------
+// Deterministic noise (std::normal_distribution differs between libraries)
+// ---------------------------------------------------------------------------
+
+struct Rng {
+    std::mt19937 gen;
+
+    explicit Rng(uint32_t seed) : gen(seed) {}
+
+    double uniform() {
+        return (static_cast<double>(gen()) + 0.5) / 4294967296.0;
+    }
+
+    double normal(double sigma) {
+        double u1 = uniform();
+        double u2 = uniform();
+        return sigma * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * kPi * u2);
+    }
+
+    int range(int lo, int hi) {
+        return lo + static_cast<int>(uniform() * (hi - lo + 1));
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Zone geometry ground truth
+// ---------------------------------------------------------------------------
+
+struct ZoneSpec {
+    int16_t x = 0;
+    int16_t y = 0;
+    int16_t width = 0;
+    int16_t height = 0;
+};
+
+// Zone-local coordinates: u runs from p1 towards p2, v from p1 towards p4
+// (see ZoneCorners in zone_core.h)
+bool truth_in_zone(const ZoneSpec& z, float angle_deg, double x, double y) {
+    if (z.width <= 0 || z.height <= 0) {
+        return false;
+    }
+    double a = angle_deg * kPi / 180.0;
+    double dx = x - z.x;
+    double dy = y - z.y;
+    double u = -dx * std::cos(a) + dy * std::sin(a);
+    double v = dx * std::sin(a) + dy * std::cos(a);
+    return u >= 0.0 && u <= z.width && v >= 0.0 && v <= z.height;
+}
+
+void zone_to_world(const ZoneSpec& z, float angle_deg, double u, double v, double& x, double& y) {
+    double a = angle_deg * kPi / 180.0;
+    x = z.x - u * std::cos(a) + v * std::sin(a);
+    y = z.y + u * std::sin(a) + v * std::cos(a);
+}
+
+Zone make_zone(const ZoneSpec& s) {
+    Zone z;
+    z.x = s.x;
+    z.y = s.y;
+    z.width = s.width;
+    z.height = s.height;
+    return z;
+}
+
+Position make_position(double x, double y) {
+    Position p;
+    p.x = static_cast<int16_t>(std::lround(x));
+    p.y = static_cast<int16_t>(std::lround(y));
+    p.valid = true;
+    return p;
+}
+
+// ---------------------------------------------------------------------------
+// Simulated device: stub entities wired into process_ld2450_data()
+// ---------------------------------------------------------------------------
+
+constexpr int NUM_ZONES = 3;
+constexpr int NUM_TARGETS = 3;
+
+struct SimDevice {
+    std::vector<uint8_t> rx_buffer;
+    unsigned long last_update = 0;
+    unsigned long update_counter = 0;
+    unsigned long last_rate_calc = 0;
+    unsigned long packet_error_count = 0;
+    bool init_zone_publish = false;
+
+    template_::TemplateNumber update_interval_ms, position_threshold, speed_threshold, wall_angle;
+    template_::TemplateSensor update_rate, packet_errors;
+    template_::TemplateTextSensor radar_status;
+    template_::TemplateSwitch zone_fn_enable, target_fn_enable, debug_mode;
+
+    template_::TemplateNumber zone_x[NUM_ZONES], zone_y[NUM_ZONES];
+    template_::TemplateNumber zone_height[NUM_ZONES], zone_width[NUM_ZONES];
+    template_::TemplateSensor zone_target_count[NUM_ZONES];
+    template_::TemplateBinarySensor zone_target_exist[NUM_ZONES];
+
+    template_::TemplateSwitch zone_ex_enable[1];
+    template_::TemplateNumber zone_ex_x[1], zone_ex_y[1], zone_ex_height[1], zone_ex_width[1];
+    template_::TemplateSensor zone_ex_target_count[1];
+    template_::TemplateBinarySensor zone_ex_target_exist[1];
+
+    template_::TemplateSensor target_angle[NUM_TARGETS];
+    template_::TemplateTextSensor target_position[NUM_TARGETS], target_direction[NUM_TARGETS];
+    template_::TemplateSensor target_x[NUM_TARGETS], target_y[NUM_TARGETS];
+    template_::TemplateSensor target_speed[NUM_TARGETS], target_resolution[NUM_TARGETS];
+    template_::TemplateSensor all_target_count;
+    template_::TemplateBinarySensor any_target_exist;
+
+    SimDevice(float angle, const std::vector<ZoneSpec>& zones, const ZoneSpec* exclusion) {
+        wall_angle.state = angle;
+        speed_threshold.state = 0.05f;
+        zone_fn_enable.state = true;
+        target_fn_enable.state = true;
+        for (size_t i = 0; i < zones.size() && i < NUM_ZONES; i++) {
+            zone_x[i].state = zones[i].x;
+            zone_y[i].state = zones[i].y;
+            zone_width[i].state = zones[i].width;
+            zone_height[i].state = zones[i].height;
+        }
+        if (exclusion) {
+            zone_ex_enable[0].state = true;
+            zone_ex_x[0].state = exclusion->x;
+            zone_ex_y[0].state = exclusion->y;
+            zone_ex_width[0].state = exclusion->width;
+            zone_ex_height[0].state = exclusion->height;
+        }
+    }
+
+    void feed(const std::vector<uint8_t>& chunk) {
+        template_::TemplateNumber* zx[] = {&zone_x[0], &zone_x[1], &zone_x[2]};
+        template_::TemplateNumber* zy[] = {&zone_y[0], &zone_y[1], &zone_y[2]};
+        template_::TemplateNumber* zh[] = {&zone_height[0], &zone_height[1], &zone_height[2]};
+        template_::TemplateNumber* zw[] = {&zone_width[0], &zone_width[1], &zone_width[2]};
+        template_::TemplateSensor* zc[] = {&zone_target_count[0], &zone_target_count[1], &zone_target_count[2]};
+        template_::TemplateBinarySensor* ze[] = {&zone_target_exist[0], &zone_target_exist[1], &zone_target_exist[2]};
+        template_::TemplateSwitch* xen[] = {&zone_ex_enable[0]};
+        template_::TemplateNumber* xx[] = {&zone_ex_x[0]};
+        template_::TemplateNumber* xy[] = {&zone_ex_y[0]};
+        template_::TemplateNumber* xh[] = {&zone_ex_height[0]};
+        template_::TemplateNumber* xw[] = {&zone_ex_width[0]};
+        template_::TemplateSensor* xc[] = {&zone_ex_target_count[0]};
+        template_::TemplateBinarySensor* xe[] = {&zone_ex_target_exist[0]};
+        template_::TemplateSensor* ta[] = {&target_angle[0], &target_angle[1], &target_angle[2]};
+        template_::TemplateTextSensor* tp[] = {&target_position[0], &target_position[1], &target_position[2]};
+        template_::TemplateTextSensor* td[] = {&target_direction[0], &target_direction[1], &target_direction[2]};
+        template_::TemplateSensor* tx[] = {&target_x[0], &target_x[1], &target_x[2]};
+        template_::TemplateSensor* ty[] = {&target_y[0], &target_y[1], &target_y[2]};
+        template_::TemplateSensor* ts[] = {&target_speed[0], &target_speed[1], &target_speed[2]};
+        template_::TemplateSensor* tr[] = {&target_resolution[0], &target_resolution[1], &target_resolution[2]};
+
+        stub_millis += 50;
+        process_ld2450_data(
+            chunk, rx_buffer, last_update, update_counter, last_rate_calc, packet_error_count, init_zone_publish,
+            &update_interval_ms, &position_threshold, &speed_threshold, &wall_angle,
+            &update_rate, &packet_errors, &radar_status,
+            &zone_fn_enable, &target_fn_enable, &debug_mode,
+            zx, zy, zh, zw, zc, ze,
+            xen, xx, xy, xh, xw, xc, xe,
+            ta, tp, td, tx, ty, ts, tr,
+            &all_target_count, &any_target_exist);
+    }
+
+    bool zone_occupied(int i) const {
+        return zone_target_count[i].state > 0;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Scenarios
+// ---------------------------------------------------------------------------
+
+struct SimPoint {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+using StepFn = std::function<void(int tick, std::vector<SimPoint>& people)>;
+
+// Recorded outcome of a scenario. The run is seeded and deterministic, so
+// the gate is exact: any change in a count means behaviour changed, and the
+// baseline must be re-recorded deliberately (the failure message prints the
+// measured values in initializer form).
+struct Baseline {
+    long tp = 0, fp = 0, fn = 0, tn = 0;
+    int truth_transitions = 0;
+    int device_transitions = 0;
+    int motion_mismatches = 0;
+};
+
+struct Scenario {
+    std::string name;
+    uint32_t seed = 0;
+    float wall_angle = 0.0f;
+    std::vector<ZoneSpec> zones;
+    bool has_exclusion = false;
+    ZoneSpec exclusion;
+    int ticks = 0;
+    double noise_mm = 0.0;
+
+    // Multipath ghosts: per person and frame, with probability ghost_rate an
+    // echo appears at the person's position scaled by [scale_min, scale_max]
+    double ghost_rate = 0.0;
+    double ghost_scale_min = 1.0;
+    double ghost_scale_max = 1.0;
+    double ghost_noise_mm = 0.0;
+
+    bool fragment = false;     // deliver frames in random pieces with junk and corrupt frames
+    StepFn step;
+    Baseline baseline;
+};
+
+struct Tally {
+    long tp = 0, fp = 0, fn = 0, tn = 0;
+    int truth_transitions = 0;
+    int device_transitions = 0;
+
+    double precision() const { return (tp + fp) ? static_cast<double>(tp) / (tp + fp) : 1.0; }
+    double recall() const { return (tp + fn) ? static_cast<double>(tp) / (tp + fn) : 1.0; }
+    int flip_flops() const { return std::max(0, device_transitions - truth_transitions); }
+};
+
+// Triangle wave between lo and hi with the given period in ticks
+double sweep(int tick, int period, double lo, double hi) {
+    double phase = static_cast<double>(tick % period) / period;
+    double t = phase < 0.5 ? phase * 2.0 : 2.0 - phase * 2.0;
+    return lo + (hi - lo) * t;
+}
+
+// Each simulated frame covers 50 ms
+constexpr double TICK_SECONDS = 0.05;
+
+const ZoneSpec ROOM_ZONE = {1000, 1000, 2000, 2000};   // x -1000..1000, y 1000..3000 at 0 deg
+
+Scenario walk_across() {
+    Scenario s;
+    s.name = "walk_across";
+    s.seed = 0x24500001;
+    s.zones = {ROOM_ZONE};
+    s.ticks = 800;
+    s.noise_mm = 40.0;
+    s.step = [](int tick, std::vector<SimPoint>& people) {
+        people.push_back({sweep(tick, 200, -2525.0, 2475.0), 2000.0});
+    };
+    s.baseline = {317, 4, 3, 476, 16, 20, 0};
+    return s;
+}
+
+Scenario walk_toward() {
+    Scenario s;
+    s.name = "walk_toward";
+    s.seed = 0x24500002;
+    s.zones = {ROOM_ZONE, {3000, 3500, 2000, 1500}};
+    s.ticks = 800;
+    s.noise_mm = 40.0;
+    s.step = [](int tick, std::vector<SimPoint>& people) {
+        people.push_back({300.0, sweep(tick, 200, 400.0, 5000.0)});
+        people.push_back({2000.0, sweep(tick + 50, 160, 2500.0, 5500.0)});
+    };
+    s.baseline = {738, 10, 6, 846, 36, 42, 0};
+    return s;
+}
+
+Scenario sit_still() {
+    Scenario s;
+    s.name = "sit_still";
+    s.seed = 0x24500003;
+    s.zones = {ROOM_ZONE, {-1500, 1000, 1500, 2000}};
+    s.ticks = 600;
+    s.noise_mm = 25.0;
+    s.step = [](int, std::vector<SimPoint>& people) {
+        people.push_back({200.0, 2000.0});       // on the sofa inside zone 1
+        people.push_back({2500.0, 1800.0});      // at the desk, outside every zone
+    };
+    s.baseline = {600, 0, 0, 600, 0, 0, 0};
+    return s;
+}
+
+// One person repeatedly crossing the side edge, then the near edge, of a
+// zone rotated by wall_angle
+Scenario edge_cross(float angle, const Baseline& baseline) {
+    Scenario s;
+    s.name = "edge_cross_" + std::to_string(static_cast<int>(angle));
+    s.seed = 0x24500100 + static_cast<uint32_t>(angle);
+    s.wall_angle = angle;
+    s.zones = {ROOM_ZONE};
+    s.ticks = 1200;
+    s.noise_mm = 50.0;
+    s.step = [angle](int tick, std::vector<SimPoint>& people) {
+        double u, v;
+        if (tick < 600) {
+            u = sweep(tick, 120, -610.0, 590.0);
+            v = ROOM_ZONE.height / 2.0;
+        } else {
+            u = ROOM_ZONE.width / 2.0;
+            v = sweep(tick, 120, -610.0, 590.0);
+        }
+        SimPoint p;
+        zone_to_world(ROOM_ZONE, angle, u, v, p.x, p.y);
+        people.push_back(p);
+    };
+    s.baseline = baseline;
+    return s;
+}
+
+// A person walking near a reflective wall; zone 2 sits where the echoes land
+Scenario multipath_ghost(const std::string& name, uint32_t seed, bool masked,
+                         double rate, double scale_min, double scale_max, double ghost_noise_mm,
+                         const Baseline& baseline) {
+    Scenario s;
+    s.name = name;
+    s.seed = seed;
+    s.zones = {{1000, 500, 2000, 2500}, {2500, 3100, 5000, 2000}};
+    s.has_exclusion = masked;
+    s.exclusion = {3000, 3050, 6000, 2500};
+    s.ticks = 1200;
+    s.noise_mm = 40.0;
+    s.ghost_rate = rate;
+    s.ghost_scale_min = scale_min;
+    s.ghost_scale_max = scale_max;
+    s.ghost_noise_mm = ghost_noise_mm;
+    s.step = [](int tick, std::vector<SimPoint>& people) {
+        people.push_back({sweep(tick, 240, -800.0, 800.0), sweep(tick, 300, 1200.0, 2400.0)});
+    };
+    s.baseline = baseline;
+    return s;
+}
+
+Scenario fragmented_stream() {
+    Scenario s = walk_across();
+    s.name = "fragmented";
+    s.seed = 0x24500004;
+    s.fragment = true;
+    s.baseline = {318, 6, 2, 474, 16, 16, 0};
+    return s;
+}
+
+// Command echo as seen with the UART debugger in direction BOTH
+const std::vector<uint8_t> TX_ECHO = {0xFD, 0xFC, 0xFB, 0xFA, 0x02, 0x00, 0xFF, 0x00, 0x04, 0x03, 0x02, 0x01};
+
+struct ScenarioResult {
+    Tally zones[NUM_ZONES];
+    Tally total;
+    int motion_mismatches = 0;
+    int dropped_ticks = 0;
+    double ns_per_frame_device = 0.0;
+    double ns_per_frame_core = 0.0;
+    unsigned long corrupted = 0;
+    unsigned long packet_errors = 0;
+};
+
+// Signed radial speed in cm/s, positive when moving away from the sensor
+int16_t radial_speed(const SimPoint& prev, const SimPoint& now) {
+    double d_mm = std::hypot(now.x, now.y) - std::hypot(prev.x, prev.y);
+    return static_cast<int16_t>(std::lround(d_mm / 10.0 / TICK_SECONDS));
+}
+
+// What target_position should read for a given true speed
+std::string expected_motion(int16_t speed_cm_s, float threshold_ms) {
+    float speed_ms = speed_cm_s / 100.0f;
+    if (speed_ms > threshold_ms) return "Moving away";
+    if (speed_ms < -threshold_ms) return "Approaching";
+    return "Static";
+}
+
+ScenarioResult run_scenario(const Scenario& s) {
+    ScenarioResult r;
+    Rng rng(s.seed);
+    const ZoneSpec* exclusion = s.has_exclusion ? &s.exclusion : nullptr;
+    SimDevice dev(s.wall_angle, s.zones, exclusion);
+
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<SimPoint> prev_people;
+    bool prev_truth[NUM_ZONES] = {false, false, false};
+    bool prev_device[NUM_ZONES] = {false, false, false};
+
+    for (int tick = 0; tick < s.ticks; tick++) {
+        std::vector<SimPoint> people;
+        s.step(tick, people);
+
+        std::vector<int16_t> speeds(people.size(), 0);
+        if (prev_people.size() == people.size()) {
+            for (size_t i = 0; i < people.size(); i++) {
+                speeds[i] = radial_speed(prev_people[i], people[i]);
+            }
+        }
+        prev_people = people;
+
+        std::vector<SimTarget> targets;
+        auto add_target = [&](double x, double y, int16_t speed, double noise_mm) {
+            if (targets.size() >= static_cast<size_t>(NUM_TARGETS)) return;
+            SimTarget t;
+            t.x = static_cast<int16_t>(std::lround(x + rng.normal(noise_mm)));
+            t.y = static_cast<int16_t>(std::lround(y + rng.normal(noise_mm)));
+            t.speed = speed;
+            t.resolution = 360;
+            targets.push_back(t);
+        };
+        for (size_t i = 0; i < people.size(); i++) {
+            add_target(people[i].x, people[i].y, speeds[i], s.noise_mm);
+        }
+        // Echoes travel further along the same bearing and share the person's speed
+        for (size_t i = 0; i < people.size(); i++) {
+            if (s.ghost_rate > 0.0 && rng.uniform() < s.ghost_rate) {
+                double scale = s.ghost_scale_min + (s.ghost_scale_max - s.ghost_scale_min) * rng.uniform();
+                add_target(people[i].x * scale, people[i].y * scale, speeds[i], s.ghost_noise_mm);
+            }
+        }
+
+        std::vector<uint8_t> frame = encode_ld2450_frame(targets);
+        frames.push_back(frame);
+
+        if (s.fragment) {
+            std::vector<uint8_t> stream;
+            if (rng.uniform() < 0.1) {
+                stream.insert(stream.end(), TX_ECHO.begin(), TX_ECHO.end());
+            }
+            if (rng.uniform() < 0.03) {
+                frame[LD2450Frame::FRAME_SIZE - 1] ^= 0xFF;
+                r.corrupted++;
+                r.dropped_ticks++;
+            }
+            stream.insert(stream.end(), frame.begin(), frame.end());
+            size_t pos = 0;
+            while (pos < stream.size()) {
+                size_t len = std::min(stream.size() - pos, static_cast<size_t>(rng.range(1, 20)));
+                dev.feed(std::vector<uint8_t>(stream.begin() + pos, stream.begin() + pos + len));
+                pos += len;
+            }
+        } else {
+            dev.feed(frame);
+        }
+
+        // Dropped frames are scored against where people really are, so
+        // their cost shows up in precision and recall
+        for (size_t i = 0; i < s.zones.size(); i++) {
+            bool truth = false;
+            for (const auto& pt : people) {
+                bool excluded = exclusion && truth_in_zone(*exclusion, s.wall_angle, pt.x, pt.y);
+                if (!excluded && truth_in_zone(s.zones[i], s.wall_angle, pt.x, pt.y)) {
+                    truth = true;
+                }
+            }
+            bool device = dev.zone_occupied(static_cast<int>(i));
+
+            Tally& t = r.zones[i];
+            if (truth && device) t.tp++;
+            else if (!truth && device) t.fp++;
+            else if (truth && !device) t.fn++;
+            else t.tn++;
+            if (tick > 0) {
+                t.truth_transitions += (truth != prev_truth[i]);
+                t.device_transitions += (device != prev_device[i]);
+            }
+            prev_truth[i] = truth;
+            prev_device[i] = device;
+        }
+
+        // People occupy the first target slots
+        for (size_t i = 0; i < people.size() && i < static_cast<size_t>(NUM_TARGETS); i++) {
+            if (dev.target_position[i].state != expected_motion(speeds[i], dev.speed_threshold.state)) {
+                r.motion_mismatches++;
+            }
+        }
+    }
+    r.packet_errors = dev.packet_error_count;
+
+    for (size_t i = 0; i < s.zones.size(); i++) {
+        r.total.tp += r.zones[i].tp;
+        r.total.fp += r.zones[i].fp;
+        r.total.fn += r.zones[i].fn;
+        r.total.tn += r.zones[i].tn;
+        r.total.truth_transitions += r.zones[i].truth_transitions;
+        r.total.device_transitions += r.zones[i].device_transitions;
+    }
+
+    // Timing: full device path, then decode + zone classification only
+    const int reps = 20;
+    SimDevice bench(s.wall_angle, s.zones, exclusion);
+    auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < reps; rep++) {
+        for (const auto& frame : frames) {
+            bench.feed(frame);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    r.ns_per_frame_device = std::chrono::duration<double, std::nano>(elapsed).count() / (reps * frames.size());
+
+    volatile int sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < reps; rep++) {
+        for (const auto& frame : frames) {
+            Position p[NUM_TARGETS];
+            parse_ld2450_targets(frame, p, NUM_TARGETS);
+            if (exclusion) {
+                Zone zex = make_zone(*exclusion);
+                count_targets_in_zone(zex, p, NUM_TARGETS, s.wall_angle, true);
+            }
+            for (const auto& spec : s.zones) {
+                Zone z = make_zone(spec);
+                count_targets_in_zone(z, p, NUM_TARGETS, s.wall_angle, false);
+                sink = sink + z.target_count;
+            }
+        }
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    r.ns_per_frame_core = std::chrono::duration<double, std::nano>(elapsed).count() / (reps * frames.size());
+    (void) sink;
+
+    return r;
+}
+
+bool check_baseline(const Scenario& s, const ScenarioResult& r) {
+    const Baseline& b = s.baseline;
+    struct { const char* name; long expected, measured; } fields[] = {
+        {"tp", b.tp, r.total.tp},
+        {"fp", b.fp, r.total.fp},
+        {"fn", b.fn, r.total.fn},
+        {"tn", b.tn, r.total.tn},
+        {"truth_transitions", b.truth_transitions, r.total.truth_transitions},
+        {"device_transitions", b.device_transitions, r.total.device_transitions},
+        {"motion_mismatches", b.motion_mismatches, r.motion_mismatches},
+    };
+    bool ok = true;
+    for (const auto& f : fields) {
+        if (f.expected != f.measured) {
+            if (ok) {
+                std::printf("FAIL %s: result differs from baseline\n", s.name.c_str());
+            }
+            std::printf("    %-18s baseline %6ld  measured %6ld  (%+ld)\n",
+                        f.name, f.expected, f.measured, f.measured - f.expected);
+            ok = false;
+        }
+    }
+    if (!ok) {
+        std::printf("    measured baseline: {%ld, %ld, %ld, %ld, %d, %d, %d}\n",
+                    r.total.tp, r.total.fp, r.total.fn, r.total.tn,
+                    r.total.truth_transitions, r.total.device_transitions, r.motion_mismatches);
+    }
+    return ok;
+}
+
+void run_scenarios() {
+    std::vector<Scenario> scenarios = {
+        walk_across(),
+        walk_toward(),
+        sit_still(),
+        edge_cross(0.0f, {567, 20, 23, 590, 20, 62, 0}),
+        edge_cross(15.0f, {572, 21, 18, 589, 20, 60, 0}),
+        edge_cross(30.0f, {572, 18, 18, 592, 20, 56, 0}),
+        edge_cross(45.0f, {574, 22, 16, 588, 20, 52, 0}),
+        multipath_ghost("ghost_masked", 0x24500201, true, 0.4, 1.8, 2.0, 40.0,
+                        {1200, 0, 0, 1200, 0, 0, 0}),
+        multipath_ghost("ghost_unmasked", 0x24500202, false, 0.4, 1.8, 2.0, 40.0,
+                        {1200, 310, 0, 890, 0, 376, 0}),
+        multipath_ghost("ghost_dense", 0x24500203, true, 0.8, 1.4, 1.7, 120.0,
+                        {1200, 0, 0, 1200, 0, 0, 0}),
+        multipath_ghost("ghost_sparse", 0x24500204, false, 0.15, 2.0, 2.4, 80.0,
+                        {1200, 131, 0, 1069, 0, 238, 0}),
+        fragmented_stream(),
+    };
+
+    std::printf("%-16s %6s %6s %9s %7s %6s %7s %6s %10s %9s\n",
+                "scenario", "angle", "frames", "precision", "recall", "flips", "dropped", "motion",
+                "ns/frame", "core ns");
+    for (const auto& s : scenarios) {
+        ScenarioResult r = run_scenario(s);
+        std::printf("%-16s %6.1f %6d %9.4f %7.4f %6d %7d %6d %10.0f %9.0f\n",
+                    s.name.c_str(), s.wall_angle, s.ticks, r.total.precision(), r.total.recall(),
+                    r.total.flip_flops(), r.dropped_ticks, r.motion_mismatches,
+                    r.ns_per_frame_device, r.ns_per_frame_core);
+
+        if (!check_baseline(s, r)) {
+            failures++;
+        }
+        if (s.fragment) {
+            // Every corrupted frame is reported; junk and fragments are not
+            CHECK(r.packet_errors == r.corrupted);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Helper unit tests
+// ---------------------------------------------------------------------------
+
+void test_frame_roundtrip() {
+    std::vector<SimTarget> targets = {{-1234, 2500, -35, 360}, {0, 120, 0, 0}, {3999, 7999, 150, 720}};
+    std::vector<uint8_t> frame = encode_ld2450_frame(targets);
+    CHECK(frame.size() == LD2450Frame::FRAME_SIZE);
+
+    Position p[NUM_TARGETS];
+    CHECK(parse_ld2450_targets(frame, p, NUM_TARGETS));
+    for (int i = 0; i < NUM_TARGETS; i++) {
+        CHECK(p[i].x == targets[i].x);
+        CHECK(p[i].y == targets[i].y);
+        CHECK(p[i].speed == targets[i].speed);
+        CHECK(p[i].distance_resolution == targets[i].resolution);
+        CHECK(p[i].valid);
+    }
+
+    // Empty slots decode as invalid targets
+    frame = encode_ld2450_frame({{500, 1000, 0, 0}});
+    CHECK(parse_ld2450_targets(frame, p, NUM_TARGETS));
+    CHECK(p[0].valid);
+    CHECK(!p[1].valid);
+    CHECK(!p[2].valid);
+}
+
+void test_parse_rejects_short_frames() {
+    std::vector<uint8_t> frame = encode_ld2450_frame({{500, 1000, 0, 0}});
+    Position p[NUM_TARGETS];
+    p[0].x = 42;
+
+    std::vector<uint8_t> truncated(frame.begin(), frame.begin() + 27);
+    CHECK(!parse_ld2450_targets(truncated, p, NUM_TARGETS));
+    CHECK(p[0].x == 42);
+    CHECK(!parse_ld2450_targets(std::vector<uint8_t>(), p, NUM_TARGETS));
+
+    // Header plus three target blocks is enough, the tail is not read
+    std::vector<uint8_t> no_tail(frame.begin(), frame.begin() + 28);
+    CHECK(parse_ld2450_targets(no_tail, p, NUM_TARGETS));
+    CHECK(p[0].x == 500);
+
+    // Fewer targets need fewer bytes
+    std::vector<uint8_t> one_target(frame.begin(), frame.begin() + 12);
+    CHECK(parse_ld2450_targets(one_target, p, 1));
+    CHECK(!parse_ld2450_targets(one_target, p, 2));
+}
+
+void test_extract_frames() {
+    std::vector<uint8_t> f1 = encode_ld2450_frame({{100, 1000, 0, 0}});
+    std::vector<uint8_t> f2 = encode_ld2450_frame({{-200, 2000, 0, 0}});
+    std::vector<uint8_t> buffer, frame;
+    unsigned long bad = 0;
+
+    // Junk, then a frame split mid-header
+    buffer.insert(buffer.end(), TX_ECHO.begin(), TX_ECHO.end());
+    buffer.insert(buffer.end(), f1.begin(), f1.begin() + 2);
+    CHECK(!extract_ld2450_frame(buffer, frame, bad));
+    CHECK(buffer.size() <= LD2450Frame::HEADER_SIZE);
+    buffer.insert(buffer.end(), f1.begin() + 2, f1.end());
+    CHECK(extract_ld2450_frame(buffer, frame, bad));
+    CHECK(frame == f1);
+    CHECK(buffer.empty());
+    CHECK(bad == 0);
+
+    // A frame with a broken tail is skipped and counted
+    std::vector<uint8_t> broken = f1;
+    broken.back() = 0x00;
+    buffer.insert(buffer.end(), broken.begin(), broken.end());
+    buffer.insert(buffer.end(), f2.begin(), f2.end());
+    CHECK(extract_ld2450_frame(buffer, frame, bad));
+    CHECK(frame == f2);
+    CHECK(bad == 1);
+    CHECK(!extract_ld2450_frame(buffer, frame, bad));
+}
+
+// Feeding a frame in pieces must produce the same result as feeding it whole
+void test_processor_fragmented_frame() {
+    std::vector<ZoneSpec> zones = {ROOM_ZONE};
+    SimDevice dev(0.0f, zones, nullptr);
+
+    std::vector<uint8_t> inside = encode_ld2450_frame({{0, 2000, 0, 0}, {2500, 2000, 0, 0}});
+    dev.feed(std::vector<uint8_t>(inside.begin(), inside.begin() + 7));
+    CHECK(dev.zone_target_count[0].state == 0);
+    CHECK(dev.packet_error_count == 0);
+    dev.feed(std::vector<uint8_t>(inside.begin() + 7, inside.begin() + 19));
+    dev.feed(std::vector<uint8_t>(inside.begin() + 19, inside.end()));
+    CHECK(dev.zone_target_count[0].state == 1);
+    CHECK(dev.all_target_count.state == 2);
+    CHECK(dev.target_x[0].state == 0);
+    CHECK(dev.target_y[0].state == 2000);
+    CHECK(dev.radar_status.state == "Ready");
+
+    // Speed is decoded and classified (cm/s, threshold 0.05 m/s)
+    std::vector<uint8_t> moving = encode_ld2450_frame({{0, 2000, 60, 0}, {2500, 2000, -60, 0}, {100, 1500, 3, 0}});
+    dev.feed(moving);
+    CHECK(dev.target_speed[0].state == 0.6f);
+    CHECK(dev.target_position[0].state == "Moving away");
+    CHECK(dev.target_position[1].state == "Approaching");
+    CHECK(dev.target_position[2].state == "Static");
+    dev.feed(inside);
+
+    // Two frames in one chunk: the newest one wins
+    std::vector<uint8_t> outside = encode_ld2450_frame({{2500, 2000, 0, 0}});
+    std::vector<uint8_t> both = inside;
+    both.insert(both.end(), outside.begin(), outside.end());
+    dev.feed(both);
+    CHECK(dev.zone_target_count[0].state == 0);
+    CHECK(dev.all_target_count.state == 1);
+    CHECK(dev.packet_error_count == 0);
+    CHECK(dev.rx_buffer.empty());
+}
+
+// Reassembly state belongs to the device, so a partial frame left in one
+// device never leaks into another
+void test_processor_buffer_isolation() {
+    std::vector<ZoneSpec> zones = {ROOM_ZONE};
+    std::vector<uint8_t> inside = encode_ld2450_frame({{0, 2000, 0, 0}});
+
+    SimDevice a(0.0f, zones, nullptr);
+    a.feed(std::vector<uint8_t>(inside.begin(), inside.begin() + 20));
+    CHECK(a.rx_buffer.size() == 20);
+
+    SimDevice b(0.0f, zones, nullptr);
+    CHECK(b.rx_buffer.empty());
+    b.feed(inside);
+    CHECK(b.zone_target_count[0].state == 1);
+    CHECK(b.rx_buffer.empty());
+    CHECK(b.packet_error_count == 0);
+    CHECK(a.rx_buffer.size() == 20);
+}
+
+void test_count_exclusion_claims() {
+    // Two overlapping exclusion zones: the first one claims the target and the
+    // second then sees it as outside (check_targets_in_zone skips claimed targets)
+    Zone ex1 = make_zone({1000, 1000, 2000, 2000});
+    Zone ex2 = make_zone({500, 1500, 1000, 1000});
+    Position p[NUM_TARGETS];
+    p[0] = make_position(0, 2000);
+    p[1] = make_position(3000, 2000);
+
+    count_targets_in_zone(ex1, p, NUM_TARGETS, 0.0f, true);
+    CHECK(ex1.target_count == 1);
+    CHECK(ex1.outside_target_count == 1);
+    CHECK(p[0].zone_ex_enter);
+    CHECK(!p[1].zone_ex_enter);
+
+    count_targets_in_zone(ex2, p, NUM_TARGETS, 0.0f, true);
+    CHECK(ex2.target_count == 0);
+    CHECK(ex2.outside_target_count == 2);
+
+    // Detection zones ignore claimed targets entirely
+    Zone z = make_zone({4000, 0, 8000, 4000});
+    count_targets_in_zone(z, p, NUM_TARGETS, 0.0f, false);
+    CHECK(z.target_count == 1);
+    CHECK(z.outside_target_count == 0);
+}
+
+void test_count_rotated_zone() {
+    ZoneSpec spec = ROOM_ZONE;
+    float angle = 30.0f;
+    Zone z = make_zone(spec);
+
+    double x, y;
+    Position p[NUM_TARGETS];
+    zone_to_world(spec, angle, 200.0, 200.0, x, y);
+    p[0] = make_position(x, y);
+    // Inside the unrotated rectangle but outside the rotated one
+    p[1] = make_position(-900.0, 1100.0);
+    CHECK(truth_in_zone(spec, 0.0f, -900.0, 1100.0));
+    CHECK(!truth_in_zone(spec, angle, -900.0, 1100.0));
+
+    count_targets_in_zone(z, p, NUM_TARGETS, angle, false);
+    CHECK(z.target_count == 1);
+    CHECK(z.outside_target_count == 1);
+}
+
+void test_edge_crossing() {
+    const float angles[] = {0.0f, 15.0f, 30.0f, 45.0f};
+    const double margin = 60.0;
+    for (float angle : angles) {
+        Zone z = make_zone(ROOM_ZONE);
+        double half_w = ROOM_ZONE.width / 2.0;
+        double half_h = ROOM_ZONE.height / 2.0;
+        struct { double u, v; bool inside; } cases[] = {
+            {-margin, half_h, false}, {margin, half_h, true},
+            {ROOM_ZONE.width - margin, half_h, true}, {ROOM_ZONE.width + margin, half_h, false},
+            {half_w, -margin, false}, {half_w, margin, true},
+            {half_w, ROOM_ZONE.height - margin, true}, {half_w, ROOM_ZONE.height + margin, false},
+        };
+        for (const auto& c : cases) {
+            double x, y;
+            zone_to_world(ROOM_ZONE, angle, c.u, c.v, x, y);
+            Position t = make_position(x, y);
+            bool inside = check_targets_in_zone(z, t, angle);
+            if (inside != c.inside) {
+                std::printf("FAIL edge angle=%.0f u=%.0f v=%.0f expected %d\n", angle, c.u, c.v, c.inside);
+                failures++;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    test_frame_roundtrip();
+    test_parse_rejects_short_frames();
+    test_extract_frames();
+    test_processor_fragmented_frame();
+    test_processor_buffer_isolation();
+    test_count_exclusion_claims();
+    test_count_rotated_zone();
+    test_edge_crossing();
+    run_scenarios();
+
+    if (failures) {
+        std::printf("%d failure(s)\n", failures);
+        return 1;
+    }
+    std::printf("all checks passed\n");
+    return 0;
+}